@@ -9,12 +9,16 @@
 #include <sys/stat.h>
 #include <limits.h>
 #include <stdbool.h>
+#include <time.h>
+#include <signal.h>
 
 #ifndef PATH_MAX
 #define PATH_MAX 4096
 #endif
 
+#ifndef SYS_CLASS_DRM_DIR
 #define SYS_CLASS_DRM_DIR "/sys/class/drm"
+#endif
 #define GPU_METRICS_REL_PATH "device/gpu_metrics"
 
 /*
@@ -277,9 +281,17 @@ static void print_set_bits32(const char *label, uint32_t value,
     printf("%s\n", printed ? "" : " none");
 }
 
-static void print_gpu_metrics(int card_id, const gpu_metrics_v13_t *metrics)
+static void print_gpu_metrics(int card_id, const gpu_metrics_v13_t *metrics,
+                              const struct timespec *host_ts)
 {
     printf("\nGPU Metrics for Card %d:\n", card_id);
+    /*
+     * Host wall clock at read time. system_clock_counter is per-GPU, so this is
+     * the key trace_merge orders by once per-node clock offsets are applied.
+     */
+    if (host_ts)
+        printf("  Host Timestamp: %" PRId64 " ns\n",
+               (int64_t)host_ts->tv_sec * 1000000000 + (int64_t)host_ts->tv_nsec);
     printf("  Structure Size: %u bytes\n", metrics->structure_size);
     printf("  Format Version: %u\n", metrics->format_version);
     printf("  Content Version: %u\n", metrics->content_version);
@@ -339,6 +351,278 @@ static void print_gpu_metrics(int card_id, const gpu_metrics_v13_t *metrics)
                     indep_throttler_bits, sizeof(indep_throttler_bits) / sizeof(indep_throttler_bits[0]));
 }
 
+/*
+ * Throttle event engine.
+ *
+ * A per-card state machine runs over every bit of throttle_status and
+ * indep_throttle_status. A limiter "starts" once its bit has been set for
+ * `debounce` consecutive samples and "ends" once it has been clear for `hold`
+ * consecutive samples; both edges are timestamped at the first sample of the
+ * run, so debouncing delays the report but not the recorded time. Each edge
+ * prints one compact EVENT line with a snapshot of the key fields, and a start
+ * can be preceded by up to `pretrigger` PRE lines from a per-card history ring.
+ */
+
+#define MAX_CARDS 64
+#define MAX_HISTORY 256
+#define THROTTLE_STATUS_BITS 32
+#define INDEP_THROTTLE_STATUS_BITS 64
+
+typedef struct {
+    int64_t ts_ns;
+    uint64_t indep_throttle_status;
+    uint32_t throttle_status;
+    uint16_t current_gfxclk;
+    uint16_t average_socket_power;
+    uint16_t temperature_hotspot;
+    uint16_t temperature_mem;
+    uint16_t temperature_hbm[4];
+    uint16_t voltage_gfx;
+    uint16_t voltage_soc;
+    uint16_t voltage_mem;
+} throttle_snapshot_t;
+
+typedef struct {
+    bool active;
+    unsigned run;              /* consecutive samples disagreeing with `active` */
+    throttle_snapshot_t edge;  /* first sample of the current run */
+    throttle_snapshot_t start; /* start edge of the active episode */
+} limiter_state_t;
+
+typedef struct {
+    bool used;
+    int card_id;
+    limiter_state_t throttle[THROTTLE_STATUS_BITS];
+    limiter_state_t indep[INDEP_THROTTLE_STATUS_BITS];
+    throttle_snapshot_t history[MAX_HISTORY];
+    size_t history_head;
+    size_t history_count;
+    int64_t last_pre_ts_ns;
+    throttle_snapshot_t last;
+} card_events_t;
+
+typedef struct {
+    unsigned debounce;
+    unsigned hold;
+    unsigned pretrigger;
+    card_events_t cards[MAX_CARDS];
+} event_engine_t;
+
+static int64_t timespec_to_ns(const struct timespec *ts)
+{
+    return (int64_t)ts->tv_sec * 1000000000 + (int64_t)ts->tv_nsec;
+}
+
+static void take_snapshot(const gpu_metrics_v13_t *metrics, int64_t ts_ns, throttle_snapshot_t *snap)
+{
+    snap->ts_ns = ts_ns;
+    snap->throttle_status = metrics->throttle_status;
+    /* All-ones means "not reported"; do not let it open every limiter. */
+    snap->indep_throttle_status = metrics->indep_throttle_status == UINT64_MAX ?
+                                  0 : metrics->indep_throttle_status;
+    snap->current_gfxclk = metrics->current_gfxclk;
+    snap->average_socket_power = metrics->average_socket_power;
+    snap->temperature_hotspot = metrics->temperature_hotspot;
+    snap->temperature_mem = metrics->temperature_mem;
+    memcpy(snap->temperature_hbm, metrics->temperature_hbm, sizeof(snap->temperature_hbm));
+    snap->voltage_gfx = metrics->voltage_gfx;
+    snap->voltage_soc = metrics->voltage_soc;
+    snap->voltage_mem = metrics->voltage_mem;
+}
+
+static void print_u16_field(const char *key, uint16_t value)
+{
+    if (value == UINT16_MAX)
+        printf(" %s=NA", key);
+    else
+        printf(" %s=%u", key, value);
+}
+
+static void print_snapshot_fields(const throttle_snapshot_t *snap)
+{
+    print_u16_field("gfxclk_mhz", snap->current_gfxclk);
+    print_u16_field("power_w", snap->average_socket_power);
+    print_u16_field("hotspot_c", snap->temperature_hotspot);
+    print_u16_field("mem_c", snap->temperature_mem);
+    for (size_t i = 0; i < sizeof(snap->temperature_hbm) / sizeof(snap->temperature_hbm[0]); ++i) {
+        char key[16];
+        snprintf(key, sizeof(key), "hbm%zu_c", i);
+        print_u16_field(key, snap->temperature_hbm[i]);
+    }
+    print_u16_field("vgfx_mv", snap->voltage_gfx);
+    print_u16_field("vsoc_mv", snap->voltage_soc);
+    print_u16_field("vmem_mv", snap->voltage_mem);
+}
+
+static void print_limiter(const char *reg, uint8_t bit, const bit_desc_t *bits, size_t bit_count)
+{
+    for (size_t i = 0; i < bit_count; ++i) {
+        if (bits[i].bit == bit) {
+            printf(" reg=%s limiter=%s", reg, bits[i].label);
+            return;
+        }
+    }
+    printf(" reg=%s limiter=BIT%u", reg, bit);
+}
+
+static card_events_t *find_card_events(event_engine_t *engine, int card_id)
+{
+    card_events_t *free_slot = NULL;
+
+    for (size_t i = 0; i < MAX_CARDS; ++i) {
+        card_events_t *card = &engine->cards[i];
+        if (card->used && card->card_id == card_id)
+            return card;
+        if (!card->used && !free_slot)
+            free_slot = card;
+    }
+
+    if (!free_slot)
+        return NULL;
+
+    memset(free_slot, 0, sizeof(*free_slot));
+    free_slot->used = true;
+    free_slot->card_id = card_id;
+    free_slot->last_pre_ts_ns = INT64_MIN;
+    return free_slot;
+}
+
+/* Print the history samples taken before `before_ns` that no earlier start already printed. */
+static void print_pretrigger(const event_engine_t *engine, card_events_t *card, int64_t before_ns)
+{
+    size_t count = card->history_count;
+    size_t oldest = (card->history_head + MAX_HISTORY - count) % MAX_HISTORY;
+    size_t eligible = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const throttle_snapshot_t *snap = &card->history[(oldest + i) % MAX_HISTORY];
+        if (snap->ts_ns < before_ns && snap->ts_ns > card->last_pre_ts_ns)
+            eligible++;
+    }
+
+    size_t skip = eligible > engine->pretrigger ? eligible - engine->pretrigger : 0;
+    for (size_t i = 0; i < count; ++i) {
+        const throttle_snapshot_t *snap = &card->history[(oldest + i) % MAX_HISTORY];
+        if (snap->ts_ns >= before_ns || snap->ts_ns <= card->last_pre_ts_ns)
+            continue;
+        if (skip) {
+            skip--;
+            continue;
+        }
+        printf("PRE card=%d ts=%" PRId64 " throttle_status=0x%08" PRIx32
+               " indep_throttle_status=0x%016" PRIx64,
+               card->card_id, snap->ts_ns, snap->throttle_status, snap->indep_throttle_status);
+        print_snapshot_fields(snap);
+        printf("\n");
+        card->last_pre_ts_ns = snap->ts_ns;
+    }
+}
+
+static void print_end_event(const card_events_t *card, const char *reg, uint8_t bit,
+                            const bit_desc_t *bits, size_t bit_count,
+                            const limiter_state_t *state, const throttle_snapshot_t *end,
+                            bool incomplete)
+{
+    printf("EVENT end card=%d", card->card_id);
+    print_limiter(reg, bit, bits, bit_count);
+    printf(" ts=%" PRId64 " duration_ns=%" PRId64, end->ts_ns, end->ts_ns - state->start.ts_ns);
+    print_snapshot_fields(end);
+    printf("%s\n", incomplete ? " incomplete=1" : "");
+}
+
+static void update_limiters(const event_engine_t *engine, card_events_t *card,
+                            limiter_state_t *states, size_t state_count, uint64_t value,
+                            const char *reg, const bit_desc_t *bits, size_t bit_count,
+                            const throttle_snapshot_t *snap)
+{
+    for (size_t bit = 0; bit < state_count; ++bit) {
+        limiter_state_t *state = &states[bit];
+        bool set = (value >> bit) & 1;
+
+        if (set == state->active) {
+            state->run = 0;
+            continue;
+        }
+
+        if (state->run++ == 0)
+            state->edge = *snap;
+        if (state->run < (state->active ? engine->hold : engine->debounce))
+            continue;
+
+        state->run = 0;
+        if (!state->active) {
+            state->active = true;
+            state->start = state->edge;
+            if (engine->pretrigger)
+                print_pretrigger(engine, card, state->start.ts_ns);
+            printf("EVENT start card=%d", card->card_id);
+            print_limiter(reg, (uint8_t)bit, bits, bit_count);
+            printf(" ts=%" PRId64, state->start.ts_ns);
+            print_snapshot_fields(&state->start);
+            printf("\n");
+        } else {
+            state->active = false;
+            print_end_event(card, reg, (uint8_t)bit, bits, bit_count, state, &state->edge, false);
+        }
+    }
+}
+
+static void event_engine_update(event_engine_t *engine, int card_id,
+                                const gpu_metrics_v13_t *metrics, int64_t ts_ns)
+{
+    card_events_t *card = find_card_events(engine, card_id);
+    throttle_snapshot_t snap;
+
+    if (!card) {
+        fprintf(stderr, "Too many cards for throttle event tracking (max %d)\n", MAX_CARDS);
+        return;
+    }
+
+    take_snapshot(metrics, ts_ns, &snap);
+    update_limiters(engine, card, card->throttle, THROTTLE_STATUS_BITS, snap.throttle_status,
+                    "throttle_status", ald_throttle_bits,
+                    sizeof(ald_throttle_bits) / sizeof(ald_throttle_bits[0]), &snap);
+    update_limiters(engine, card, card->indep, INDEP_THROTTLE_STATUS_BITS, snap.indep_throttle_status,
+                    "indep_throttle_status", indep_throttler_bits,
+                    sizeof(indep_throttler_bits) / sizeof(indep_throttler_bits[0]), &snap);
+
+    card->history[card->history_head] = snap;
+    card->history_head = (card->history_head + 1) % MAX_HISTORY;
+    if (card->history_count < MAX_HISTORY)
+        card->history_count++;
+    card->last = snap;
+}
+
+/*
+ * Close episodes still open when sampling stops. A limiter whose bit already
+ * cleared and was only waiting out --hold ended at that first clear sample;
+ * otherwise it is cut at the last sample seen.
+ */
+static void flush_limiters(const card_events_t *card, const limiter_state_t *states, size_t state_count,
+                           const char *reg, const bit_desc_t *bits, size_t bit_count)
+{
+    for (size_t bit = 0; bit < state_count; ++bit) {
+        const limiter_state_t *state = &states[bit];
+        if (state->active)
+            print_end_event(card, reg, (uint8_t)bit, bits, bit_count, state,
+                            state->run ? &state->edge : &card->last, true);
+    }
+}
+
+static void event_engine_flush(event_engine_t *engine)
+{
+    for (size_t i = 0; i < MAX_CARDS; ++i) {
+        card_events_t *card = &engine->cards[i];
+        if (!card->used)
+            continue;
+
+        flush_limiters(card, card->throttle, THROTTLE_STATUS_BITS, "throttle_status", ald_throttle_bits,
+                       sizeof(ald_throttle_bits) / sizeof(ald_throttle_bits[0]));
+        flush_limiters(card, card->indep, INDEP_THROTTLE_STATUS_BITS, "indep_throttle_status",
+                       indep_throttler_bits, sizeof(indep_throttler_bits) / sizeof(indep_throttler_bits[0]));
+    }
+}
+
 static int parse_card_id(const char *name, int *card_id)
 {
     const char *p;
@@ -383,21 +667,127 @@ static int parse_card_index(const char *arg, int *card_id)
     return 1;
 }
 
+static int parse_count(const char *arg, unsigned *count)
+{
+    int value;
+
+    if (!parse_card_index(arg, &value))
+        return 0;
+
+    *count = (unsigned)value;
+    return 1;
+}
+
 static void print_usage(const char *prog)
 {
-    printf("Usage: %s [--all] [-c N | --card N | --card=N]\n", prog);
+    printf("Usage: %s [--all] [-c N | --card N | --card=N] [--timestamp]\n"
+           "       [--interval MS] [--events [--raw] [--debounce N] [--hold N] [--pretrigger N]]\n", prog);
     printf("  --all            Scan all cards under /sys/class/drm (default)\n");
     printf("  -c N, --card N   Show only card N\n");
     printf("  --legend         Print glossary and ASCII map, then continue\n");
+    printf("  --timestamp      Print the host CLOCK_REALTIME time of each read\n");
+    printf("  --interval MS    Keep sampling every MS milliseconds until SIGINT/SIGTERM\n");
+    printf("  --events         Print throttle start/end EVENT lines instead of full metrics\n");
+    printf("  --raw            With --events, also print the full metrics of every sample\n");
+    printf("  --debounce N     Samples a limiter bit must stay set before it starts (default 1)\n");
+    printf("  --hold N         Samples a limiter bit must stay clear before it ends (default 1)\n");
+    printf("  --pretrigger N   Print up to N PRE samples leading up to each start (default 0)\n");
     printf("  -h, --help       Show this help\n");
 }
 
+static volatile sig_atomic_t stop_requested = 0;
+
+static void handle_stop_signal(int signo)
+{
+    (void)signo;
+    stop_requested = 1;
+}
+
+/*
+ * Read every selected card once. Returns the number of cards read and sets
+ * *found_requested when the single requested card was among them.
+ */
+static int sample_cards(bool list_all, int requested_card, bool show_raw, bool show_timestamp,
+                        event_engine_t *engine, bool *found_requested)
+{
+    DIR *dir;
+    struct dirent *ent;
+    int found = 0;
+
+    dir = opendir(SYS_CLASS_DRM_DIR);
+    if (!dir) {
+        fprintf(stderr, "Error opening %s: %s\n", SYS_CLASS_DRM_DIR, strerror(errno));
+        return -1;
+    }
+
+    while ((ent = readdir(dir)) != NULL) {
+        int card_id;
+        char path[PATH_MAX];
+        struct stat st;
+
+        if (!parse_card_id(ent->d_name, &card_id))
+            continue;
+        if (!list_all && card_id != requested_card)
+            continue;
+
+        snprintf(path, sizeof(path), "%s/%s/%s", SYS_CLASS_DRM_DIR, ent->d_name, GPU_METRICS_REL_PATH);
+        if (stat(path, &st) != 0) {
+            if (errno != ENOENT)
+                fprintf(stderr, "Error stating %s: %s\n", path, strerror(errno));
+            continue;
+        }
+
+        if (!S_ISREG(st.st_mode))
+            continue;
+
+        FILE *file = fopen(path, "rb");
+        if (!file) {
+            fprintf(stderr, "Error opening %s: %s\n", path, strerror(errno));
+            continue;
+        }
+
+        gpu_metrics_v13_t metrics;
+        struct timespec host_ts;
+        clock_gettime(CLOCK_REALTIME, &host_ts);
+        size_t read_size = fread(&metrics, 1, sizeof(metrics), file);
+        fclose(file);
+
+        if (read_size < sizeof(metrics)) {
+            fprintf(stderr,
+                    "Error reading GPU metrics for card %d: expected %zu bytes, read %zu bytes\n",
+                    card_id, sizeof(metrics), read_size);
+            continue;
+        }
+
+        if (show_raw)
+            print_gpu_metrics(card_id, &metrics, show_timestamp ? &host_ts : NULL);
+        if (engine)
+            event_engine_update(engine, card_id, &metrics, timespec_to_ns(&host_ts));
+        found++;
+        if (!list_all && card_id == requested_card) {
+            *found_requested = true;
+            break;
+        }
+    }
+
+    closedir(dir);
+    return found;
+}
+
 int main(int argc, char **argv)
 {
     int requested_card = -1;
     bool list_all = true;
     bool found_requested = false;
     bool show_legend = false;
+    bool show_timestamp = false;
+    bool show_events = false;
+    bool show_raw = false;
+    unsigned interval_ms = 0;
+    unsigned debounce = 1;
+    unsigned hold = 1;
+    unsigned pretrigger = 0;
+    const char *event_option = NULL;
 
     for (int i = 1; i < argc; ++i) {
         if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
@@ -408,6 +798,44 @@ int main(int argc, char **argv)
             show_legend = true;
             continue;
         }
+        if (strcmp(argv[i], "--timestamp") == 0) {
+            show_timestamp = true;
+            continue;
+        }
+        if (strcmp(argv[i], "--events") == 0) {
+            show_events = true;
+            continue;
+        }
+        if (strcmp(argv[i], "--raw") == 0) {
+            show_raw = true;
+            event_option = argv[i];
+            continue;
+        }
+        if (strcmp(argv[i], "--interval") == 0 || strcmp(argv[i], "--debounce") == 0 ||
+            strcmp(argv[i], "--hold") == 0 || strcmp(argv[i], "--pretrigger") == 0) {
+            unsigned value;
+
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Missing value after %s\n", argv[i]);
+                return EXIT_FAILURE;
+            }
+            if (!parse_count(argv[i + 1], &value)) {
+                fprintf(stderr, "Invalid value for %s: %s\n", argv[i], argv[i + 1]);
+                return EXIT_FAILURE;
+            }
+            if (strcmp(argv[i], "--interval") == 0)
+                interval_ms = value;
+            else if (strcmp(argv[i], "--debounce") == 0)
+                debounce = value;
+            else if (strcmp(argv[i], "--hold") == 0)
+                hold = value;
+            else
+                pretrigger = value;
+            if (strcmp(argv[i], "--interval") != 0)
+                event_option = argv[i];
+            ++i;
+            continue;
+        }
         if (strcmp(argv[i], "--all") == 0) {
             requested_card = -1;
             list_all = true;
@@ -440,74 +868,98 @@ int main(int argc, char **argv)
         return EXIT_FAILURE;
     }
 
-    if (show_legend)
-        print_intro();
-
-    DIR *dir;
-    struct dirent *ent;
-    int found = 0;
-
-    dir = opendir(SYS_CLASS_DRM_DIR);
-    if (!dir) {
-        fprintf(stderr, "Error opening %s: %s\n", SYS_CLASS_DRM_DIR, strerror(errno));
+    if (event_option && !show_events) {
+        fprintf(stderr, "%s requires --events\n", event_option);
+        return EXIT_FAILURE;
+    }
+    if (debounce == 0 || hold == 0) {
+        fprintf(stderr, "--debounce and --hold must be at least 1\n");
+        return EXIT_FAILURE;
+    }
+    /* The start edge is debounce - 1 samples back, and the window sits behind it. */
+    if (pretrigger > 0 && (debounce > MAX_HISTORY || pretrigger > MAX_HISTORY - (debounce - 1))) {
+        fprintf(stderr, "--pretrigger + --debounce - 1 must not exceed %d\n", MAX_HISTORY);
         return EXIT_FAILURE;
     }
 
-    while ((ent = readdir(dir)) != NULL) {
-        int card_id;
-        char path[PATH_MAX];
-        struct stat st;
-
-        if (!parse_card_id(ent->d_name, &card_id))
-            continue;
-        if (!list_all && card_id != requested_card)
-            continue;
+    if (show_legend)
+        print_intro();
 
-        snprintf(path, sizeof(path), "%s/%s/%s", SYS_CLASS_DRM_DIR, ent->d_name, GPU_METRICS_REL_PATH);
-        if (stat(path, &st) != 0) {
-            if (errno != ENOENT)
-                fprintf(stderr, "Error stating %s: %s\n", path, strerror(errno));
-            continue;
+    event_engine_t *engine = NULL;
+    if (show_events) {
+        engine = calloc(1, sizeof(*engine));
+        if (!engine) {
+            fprintf(stderr, "Out of memory allocating the throttle event engine\n");
+            return EXIT_FAILURE;
         }
+        engine->debounce = debounce;
+        engine->hold = hold;
+        engine->pretrigger = pretrigger;
+    } else {
+        show_raw = true;
+    }
 
-        if (!S_ISREG(st.st_mode))
-            continue;
+    if (interval_ms > 0) {
+        struct sigaction sa;
 
-        FILE *file = fopen(path, "rb");
-        if (!file) {
-            fprintf(stderr, "Error opening %s: %s\n", path, strerror(errno));
-            continue;
-        }
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = handle_stop_signal;
+        sigemptyset(&sa.sa_mask);
+        sigaction(SIGINT, &sa, NULL);
+        sigaction(SIGTERM, &sa, NULL);
+    }
 
-        gpu_metrics_v13_t metrics;
-        size_t read_size = fread(&metrics, 1, sizeof(metrics), file);
-        fclose(file);
+    int status = EXIT_SUCCESS;
+    struct timespec next;
+    clock_gettime(CLOCK_MONOTONIC, &next);
 
-        if (read_size < sizeof(metrics)) {
-            fprintf(stderr,
-                    "Error reading GPU metrics for card %d: expected %zu bytes, read %zu bytes\n",
-                    card_id, sizeof(metrics), read_size);
-            continue;
+    for (bool first = true; !stop_requested; first = false) {
+        int found = sample_cards(list_all, requested_card, show_raw, show_timestamp,
+                                 engine, &found_requested);
+
+        if (first) {
+            if (found < 0) {
+                status = EXIT_FAILURE;
+                break;
+            }
+            if (!list_all && !found_requested) {
+                fprintf(stderr, "Card %d not found or no gpu_metrics available\n", requested_card);
+                status = EXIT_FAILURE;
+                break;
+            }
+            if (found == 0) {
+                fprintf(stderr, "No gpu_metrics files found under %s\n", SYS_CLASS_DRM_DIR);
+                /* Polling forever for cards that never appear helps no one. */
+                if (interval_ms > 0) {
+                    status = EXIT_FAILURE;
+                    break;
+                }
+            }
         }
 
-        print_gpu_metrics(card_id, &metrics);
-        found++;
-        if (!list_all && card_id == requested_card) {
-            found_requested = true;
+        if (interval_ms == 0)
             break;
+        fflush(stdout);
+
+        /* Sleep to an absolute deadline so the period does not drift with read time. */
+        struct timespec now;
+        next.tv_sec += interval_ms / 1000;
+        next.tv_nsec += (long)(interval_ms % 1000) * 1000000;
+        if (next.tv_nsec >= 1000000000) {
+            next.tv_sec++;
+            next.tv_nsec -= 1000000000;
         }
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (timespec_to_ns(&next) < timespec_to_ns(&now))
+            next = now;
+        else
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
     }
 
-    closedir(dir);
-
-    if (!list_all && !found_requested) {
-        fprintf(stderr, "Card %d not found or no gpu_metrics available\n", requested_card);
-        return EXIT_FAILURE;
-    }
-
-    if (found == 0) {
-        fprintf(stderr, "No gpu_metrics files found under %s\n", SYS_CLASS_DRM_DIR);
+    if (engine) {
+        event_engine_flush(engine);
+        free(engine);
     }
 
-    return EXIT_SUCCESS;
+    return status;
 }
@@ -1,13 +1,16 @@
 #!/bin/bash
 
-grep -E 'throttle_status: 0x(?!0{8})|indep_throttle_status: 0x(?!0{16})' gpu_throttling_output.txt
+# Usage: ./identify-throttling.sh [TRACE] (defaults to gpu_throttling_output.txt)
+TRACE_FILE=${1:-gpu_throttling_output.txt}
+
+grep -E 'throttle_status: 0x(?!0{8})|indep_throttle_status: 0x(?!0{16})' "$TRACE_FILE"
 if [ $? -eq 0 ]; then
     echo "Throttling status change detected during the run."
 else
     echo "No throttling status change detected during the run."
 fi
 
-grep -E 'throttle_status reasons: (?!none)|indep_throttle_status reasons: (?!none)' gpu_throttling_output.txt
+grep -E 'throttle_status reasons: (?!none)|indep_throttle_status reasons: (?!none)' "$TRACE_FILE"
 if [ $? -eq 0 ]; then
     echo "Throttling reasons detected during the run."
 else
@@ -31,16 +31,21 @@ source ./load-amd-env.sh
 
 rm -f gpu_throttling_output.txt
 
-(
-  while true; do
-    ./gpu_metrics8_throttling >> gpu_throttling_output.txt
-    sleep $(echo "scale=3; $WAIT_BETWEEN_METRICS_MS / 1000" | bc)
-  done
-) &
+# Set RAW_METRICS=0 to record only the throttle EVENT/PRE lines
+if [ "${RAW_METRICS:-1}" = "1" ]; then
+  RAW_FLAG=--raw
+else
+  RAW_FLAG=
+fi
+
+./gpu_metrics8_throttling --timestamp --interval $WAIT_BETWEEN_METRICS_MS \
+  --events $RAW_FLAG --debounce ${THROTTLE_DEBOUNCE:-1} --hold ${THROTTLE_HOLD:-1} \
+  --pretrigger ${THROTTLE_PRETRIGGER:-0} >> gpu_throttling_output.txt &
 WATCH_PID=$!
 
 # Run the GPU application that generates a square wave pattern
-srun -n 8 -c 7 --gpus-per-task=1 --gpu-bind=closest ./step_function --vector_size $VECTOR_SIZE --n_steps $ITERATIONS --time_active $ACTIVE_PERIOD_MS --time_sleep $IDLE_PERIOD_MS
+srun -n 8 -c 7 --gpus-per-task=1 --gpu-bind=closest ./step_function --vector_size $VECTOR_SIZE --n_steps $ITERATIONS --time_active $ACTIVE_PERIOD_MS --time_sleep $IDLE_PERIOD_MS --clock_offsets clock_offsets.txt
 
-# After the application finishes, kill the watch process
-kill $WATCH_PID
\ No newline at end of file
+# After the application finishes, stop the collector; it closes any open throttle events on exit
+kill $WATCH_PID
+wait $WATCH_PID
\ No newline at end of file
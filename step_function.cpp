@@ -1,4 +1,9 @@
 #include <iostream>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+#include <time.h>
 #include <mpi.h>
 #include <hip/hip_runtime.h>
 
@@ -18,6 +23,41 @@ bool parameter_exists(const std::string& option, char** begin, char** end ){
   return std::find(begin, end, option) != end;
 }
 
+int64_t realtime_ns(){
+  timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+}
+
+// Every rank reads CLOCK_REALTIME as it leaves the same MPI_Barrier, so the
+// difference to rank 0's reading approximates that node's clock offset.
+// Rank 0 writes one "node offset_ns" line per node for trace_merge --offsets.
+void write_clock_offsets(const char* path, int rank, int size){
+  char host[MPI_MAX_PROCESSOR_NAME] = {0};
+  int host_len = 0;
+  MPI_Get_processor_name(host, &host_len);
+
+  // The first barrier absorbs connection setup so the second one is tight.
+  MPI_Barrier(MPI_COMM_WORLD);
+  MPI_Barrier(MPI_COMM_WORLD);
+  int64_t now = realtime_ns();
+
+  std::vector<int64_t> stamps(rank == 0 ? size : 0);
+  std::vector<char> hosts(rank == 0 ? size * MPI_MAX_PROCESSOR_NAME : 0);
+  MPI_Gather(&now, 1, MPI_INT64_T, stamps.data(), 1, MPI_INT64_T, 0, MPI_COMM_WORLD);
+  MPI_Gather(host, MPI_MAX_PROCESSOR_NAME, MPI_CHAR, hosts.data(), MPI_MAX_PROCESSOR_NAME, MPI_CHAR, 0, MPI_COMM_WORLD);
+  if (rank != 0) return;
+
+  std::ofstream out(path);
+  out << "# node offset_ns (CLOCK_REALTIME minus rank 0, sampled after MPI_Barrier)" << std::endl;
+  std::set<std::string> seen;
+  for (int r = 0; r < size; r++){
+    std::string name(&hosts[r * MPI_MAX_PROCESSOR_NAME]);
+    if (seen.insert(name).second) out << name << " " << stamps[r] - stamps[0] << std::endl;
+  }
+  if (!out) std::cout << "WARNING: could not write clock offsets to " << path << std::endl;
+}
+
 template<typename T, int iter>
 __global__ void vectorAdd(T *buf, const uint64_t n) {
     const uint32_t gid = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
@@ -52,11 +92,13 @@ int main(int argc, char** argv) {
   int n_steps = 5;
   uint64_t n = 1024*1024*1024;
   uint64_t n_experiments = 100;
+  const char* clock_offsets_path = nullptr;
 
   if (parameter_exists("--vector_size", argv, argv+argc)) n = std::stoi(get_parameter("--vector_size", argv, argv+argc));
   if (parameter_exists("--time_sleep", argv, argv+argc)) time_sleep = std::stoi(get_parameter("--time_sleep", argv, argv+argc));
   if (parameter_exists("--time_active", argv, argv+argc)) time_active = std::stoi(get_parameter("--time_active", argv, argv+argc));
   if (parameter_exists("--n_steps", argv, argv+argc)) n_steps = std::stoi(get_parameter("--n_steps", argv, argv+argc));
+  if (parameter_exists("--clock_offsets", argv, argv+argc)) clock_offsets_path = get_parameter("--clock_offsets", argv, argv+argc);
   
   // time_sleep = static_cast<int>(time_sleep / 1e3);
   
@@ -65,6 +107,8 @@ int main(int argc, char** argv) {
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   MPI_Comm_size(MPI_COMM_WORLD, &size);
   
+  if (clock_offsets_path) write_clock_offsets(clock_offsets_path, rank, size);
+  
   if (n <134217728){
    if (rank ==0) std::cout << "WARNING: vector_size is too small. setting to 134217728" << std::endl;
   }
@@ -0,0 +1,175 @@
+#!/usr/bin/env bash
+# Drive the collector's throttle event engine with a synthetic sysfs tree.
+# The collector is rebuilt with SYS_CLASS_DRM_DIR pointing at a scratch
+# drm/cardN/device/gpu_metrics tree, and each frame is written only after the
+# previous sample has been logged, so the sample sequence is deterministic.
+# Usage: tests/test_throttle_events.sh [path/to/trace_merge]
+
+set -u
+
+REPO=$(cd "$(dirname "$0")/.." && pwd)
+TRACE_MERGE=$(realpath "${1:-$REPO/trace_merge}")
+WORK=$(mktemp -d)
+COLLECTOR_PID=
+trap '[ -n "$COLLECTOR_PID" ] && kill $COLLECTOR_PID 2> /dev/null; rm -rf "$WORK"' EXIT
+
+FAILED=0
+
+fail() {
+  echo "FAIL: $1"
+  FAILED=1
+}
+
+${CC:-gcc} -Wall -Wextra -O2 -DSYS_CLASS_DRM_DIR="\"$WORK/drm\"" \
+  "$REPO/gpu_metrics8_throttling.c" -o "$WORK/collector" || exit 1
+mkdir -p "$WORK/drm/card0/device" "$WORK/drm/card1/device"
+
+# Per-sample status bits. card0 drives indep_throttle_status bit 0 (PPT0):
+# a glitch inside an episode (6), a one-sample blip (14) and an episode that
+# is still counting down --hold when sampling stops (19-20). card1 drives
+# throttle_status: a blip on bit 2 (3) and bit 6 (TEMP_GPU) set until the end.
+CARD0_INDEP=(0 0 0 0 1 1 0 1 1 1 0 0 0 0 1 0 0 1 1 0 0)
+CARD1_THROTTLE=(0 0 0 4 0 0 0 0 0 0 64 64 64 64 64 64 64 64 64 64 64)
+SAMPLES=${#CARD0_INDEP[@]}
+
+# Pre-build every frame so stepping is a rename, not a Python start-up.
+# current_gfxclk = 1700 - STEP tags each sample's snapshot.
+python3 - "$WORK/frames" "${CARD0_INDEP[*]}" "${CARD1_THROTTLE[*]}" <<'PY' || exit 1
+import os, struct, sys
+frames, indep0, throttle1 = sys.argv[1], sys.argv[2].split(), sys.argv[3].split()
+os.makedirs(frames)
+for step in range(len(indep0)):
+    for card, (throttle, indep) in enumerate([(0, int(indep0[step])), (int(throttle1[step]), 0)]):
+        clocks = [1700 - step] * 8 + [0xFFFF] * 6
+        data = struct.pack('<HBB10HQQ14HIHHHHII4HQHHHHQ',
+                           120, 1, 3,
+                           40, 60 + step, 50, 45, 45, 45, 100, 10, 0, 200 + step,
+                           0, 0, *clocks,
+                           throttle, 0xFFFF, 16, 160, 0, 0, 0,
+                           50, 51, 52, 53, 0,
+                           0xFFFF, 800, 1200, 0, indep)
+        assert len(data) == 120
+        with open(f'{frames}/{step}.card{card}', 'wb') as f:
+            f.write(data)
+PY
+
+write_frame() {
+  for card in 0 1; do
+    cp "$WORK/frames/$1.card$card" "$WORK/drm/card$card/device/gpu_metrics.tmp"
+    mv "$WORK/drm/card$card/device/gpu_metrics.tmp" "$WORK/drm/card$card/device/gpu_metrics"
+  done
+}
+
+# wait_for_samples N: until N samples of both cards are in the log
+wait_for_samples() {
+  local want=$(( $1 * 2 ))
+  for _ in $(seq 500); do
+    [ "$(grep -c '^GPU Metrics for Card' "$WORK/out.txt")" -ge "$want" ] && return 0
+    sleep 0.01
+  done
+  return 1
+}
+
+write_frame 0
+"$WORK/collector" --timestamp --interval 250 --events --raw \
+  --debounce 2 --hold 3 --pretrigger 2 > "$WORK/out.txt" 2> "$WORK/err.txt" &
+COLLECTOR_PID=$!
+
+for (( step = 1; step < SAMPLES; ++step )); do
+  if ! wait_for_samples "$step"; then
+    fail "collector stalled before sample $step: $(cat "$WORK/err.txt")"
+    exit 1
+  fi
+  write_frame "$step"
+done
+wait_for_samples "$SAMPLES" || fail "collector never logged the last sample"
+kill -TERM $COLLECTOR_PID
+wait $COLLECTOR_PID || fail "collector exited non-zero after SIGTERM"
+COLLECTOR_PID=
+
+# A sample that raced its frame would make every check below misleading.
+EXPECTED_CLOCKS=$(for (( step = 0; step < SAMPLES; ++step )); do echo $(( 1700 - step )); done)
+for card in 0 1; do
+  clocks=$(awk -v card="$card" '/^GPU Metrics for Card/ { c = $5; sub(":", "", c) }
+                                /^  Current GFX Clock:/ && c == card { print $4 }' "$WORK/out.txt")
+  [ "$clocks" = "$EXPECTED_CLOCKS" ] || { fail "card$card samples out of step with frames (timing)"; exit 1; }
+done
+
+# events CARD: "KIND limiter gfxclk [incomplete]" per EVENT/PRE line of CARD
+events() {
+  awk -v card="card=$1" '
+    ($1 == "EVENT" || $1 == "PRE") && index($0, " " card " ") {
+      kind = ($1 == "PRE") ? "PRE" : $2
+      limiter = "-"; clk = "?"; tail = ""
+      for (i = 2; i <= NF; ++i) {
+        if ($i ~ /^limiter=/) limiter = substr($i, 9)
+        if ($i ~ /^gfxclk_mhz=/) clk = substr($i, 12)
+        if ($i == "incomplete=1") tail = " incomplete"
+      }
+      print kind, limiter, clk tail
+    }' "$WORK/out.txt"
+}
+
+# card0: debounce drops the blip at 14, hold bridges the glitch at 6, PRE
+# shows the two samples before each start, and the final episode is flushed
+# at its first clear sample (19 -> 1681), not the last sample (20 -> 1680).
+cat > "$WORK/expected0.txt" <<'END'
+PRE - 1698
+PRE - 1697
+start PPT0 1696
+end PPT0 1690
+PRE - 1685
+PRE - 1684
+start PPT0 1683
+end PPT0 1681 incomplete
+END
+events 0 > "$WORK/actual0.txt"
+diff -u "$WORK/expected0.txt" "$WORK/actual0.txt" > /dev/null ||
+  fail "card0 events differ: $(diff "$WORK/expected0.txt" "$WORK/actual0.txt" | tr '\n' ' ')"
+
+# card1: the bit-2 blip never starts; TEMP_GPU is still set at exit.
+cat > "$WORK/expected1.txt" <<'END'
+PRE - 1692
+PRE - 1691
+start TEMP_GPU 1690
+end TEMP_GPU 1680 incomplete
+END
+events 1 > "$WORK/actual1.txt"
+diff -u "$WORK/expected1.txt" "$WORK/actual1.txt" > /dev/null ||
+  fail "card1 events differ: $(diff "$WORK/expected1.txt" "$WORK/actual1.txt" | tr '\n' ' ')"
+
+# Edges carry the timestamp of the sample they happened at.
+sample_ts() {
+  awk -v card="$1" -v step="$2" '
+    /^GPU Metrics for Card/ { c = $5; sub(":", "", c) }
+    /^  Host Timestamp:/ && c == card { if (n++ == step) print $3 }' "$WORK/out.txt"
+}
+field() {
+  grep "^EVENT $1 card=0 " "$WORK/out.txt" | head -1 | tr ' ' '\n' | sed -n "s/^$2=//p"
+}
+[ "$(field start ts)" = "$(sample_ts 0 4)" ] || fail "start ts is not the first set sample"
+[ "$(field end ts)" = "$(sample_ts 0 10)" ] || fail "end ts is not the first clear sample"
+[ "$(field end duration_ns)" = "$(( $(sample_ts 0 10) - $(sample_ts 0 4) ))" ] || fail "duration_ns is not end - start"
+
+# The log merges as a trace with events ordered by their own ts=.
+if [ -x "$TRACE_MERGE" ]; then
+  "$TRACE_MERGE" node=$WORK/out.txt > "$WORK/merged.txt" 2> "$WORK/merge.err" || fail "trace_merge failed"
+  grep -q 'later than the reorder window' "$WORK/merge.err" && fail "events fell outside the reorder window"
+  awk '/^  Merged Timestamp:/ { print $3 }
+       /^(EVENT|PRE) / { for (i = 1; i <= NF; ++i) if ($i ~ /^merged_ts=/) print substr($i, 11) }' \
+    "$WORK/merged.txt" | sort -c -n 2> /dev/null || fail "merged log is not in timestamp order"
+  [ "$(grep -c '^EVENT .* node=node merged_ts=' "$WORK/merged.txt")" = 6 ] || fail "merged EVENT lines not tagged"
+fi
+
+# Options that only make sense with --events are rejected without it.
+"$WORK/collector" --pretrigger 4 2> /dev/null && fail "--pretrigger without --events accepted"
+
+# With --interval, a tree without cards is an error rather than a busy loop.
+rm -rf "$WORK/drm"/card*
+timeout 5 "$WORK/collector" --interval 50 2> /dev/null
+[ $? -eq 1 ] || fail "--interval with no cards should exit 1"
+
+if [ "$FAILED" -eq 0 ]; then
+  echo "PASS: throttle events"
+fi
+exit "$FAILED"
@@ -0,0 +1,99 @@
+#!/usr/bin/env bash
+# Merge synthetic per-node traces with known clock offsets and check the result.
+# Usage: tests/test_trace_merge.sh [path/to/trace_merge]
+
+set -u
+
+TRACE_MERGE=$(realpath "${1:-./trace_merge}")
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+cd "$WORK" || exit 1
+
+FAILED=0
+
+fail() {
+  echo "FAIL: $1"
+  FAILED=1
+}
+
+# write_trace FILE CARD HOST_TS...: one collector record per timestamp
+write_trace() {
+  local file=$1 card=$2
+  shift 2
+  : > "$file"
+  for ts in "$@"; do
+    printf '\nGPU Metrics for Card %s:\n  Host Timestamp: %s ns\n  System Clock Counter: 7 ns\n  throttle_status: 0x00000000\n' \
+      "$card" "$ts" >> "$file"
+  done
+}
+
+# summary FILE: "node card merged_ts" per record, in output order
+summary() {
+  awk '/^GPU Metrics for Card/ { card = $5; sub(":", "", card) }
+       /^  Node:/ { node = $2 }
+       /^  Merged Timestamp:/ { print node, card, $3 }' "$1"
+}
+
+# Node clocks: n1 is the reference, n2 runs 1000 ns ahead, n3 500 ns behind.
+write_trace n1.txt 0 100 300 500
+write_trace n2.txt 1 1200 1400 1600
+write_trace n3.txt 2 -300 -100 0
+printf '# node offset_ns\nn1 0\nn2 1000\nn3 -500\n' > offsets.txt
+
+# --- ordering, tags and tie-break -------------------------------------------
+# Corrected n2 = 200 400 600, n3 = 200 400 500. Ties at 200/400 keep input order
+# (n2 before n3), and n1's 500 comes before n3's 500.
+if ! "$TRACE_MERGE" --offsets offsets.txt -o merged.txt n1.txt n2.txt n3.txt 2> merge.err; then
+  fail "merge exited non-zero: $(cat merge.err)"
+fi
+cat > expected.txt <<'END'
+n1 0 100
+n2 1 200
+n3 2 200
+n1 0 300
+n2 1 400
+n3 2 400
+n1 0 500
+n3 2 500
+n2 1 600
+END
+summary merged.txt > actual.txt
+diff -u expected.txt actual.txt > /dev/null || fail "merged order/tags differ: $(diff expected.txt actual.txt | tr '\n' ' ')"
+grep -q 'Merged 9 records from 3 traces' merge.err || fail "unexpected merge summary: $(cat merge.err)"
+[ "$(grep -c '^  throttle_status: ' merged.txt 2> /dev/null)" = 9 ] || fail "record bodies not carried through"
+grep -q 'Host Timestamp' merged.txt && fail "Host Timestamp should be replaced by Merged Timestamp"
+
+# NODE=TRACE overrides the file-name node and --offset overrides the file.
+"$TRACE_MERGE" --offsets offsets.txt --offset renamed=0 n1.txt renamed=n2.txt n3.txt > renamed.txt 2> /dev/null
+[ "$(summary renamed.txt | head -1)" = "n1 0 100" ] || fail "NODE=TRACE ordering wrong"
+summary renamed.txt | grep -q '^renamed 1 1200$' || fail "NODE=TRACE label or --offset not applied"
+
+# --window after the inputs must size every input's reorder window.
+for i in $(seq 400); do
+  printf '\nGPU Metrics for Card 0:\n  Host Timestamp: %s ns\n' "$i"
+done > long.txt
+"$TRACE_MERGE" long.txt --window 1000 > long_merged.txt 2> long.err || fail "--window after an input failed: $(cat long.err)"
+[ "$(summary long_merged.txt | wc -l)" = 400 ] || fail "--window after an input lost records"
+summary long_merged.txt | awk '{ print $3 }' | sort -c -n 2> /dev/null || fail "--window after an input misordered records"
+
+# --- unmatched offsets ---------------------------------------------------------
+if "$TRACE_MERGE" --offset nodeX=5 n1.txt > /dev/null 2> unmatched.err; then
+  fail "input without an offset should fail once offsets are given"
+fi
+grep -q "no clock offset for node 'n1'" unmatched.err || fail "missing-offset error not reported"
+grep -q "clock offset for node 'nodeX' matches no input" unmatched.err || fail "unused offset not reported"
+
+"$TRACE_MERGE" --offsets offsets.txt n1.txt n2.txt > /dev/null 2> unused.err || fail "unused offset should only warn"
+grep -q "clock offset for node 'n3' matches no input" unused.err || fail "unused offset warning missing"
+
+# --- records without a Host Timestamp -------------------------------------------
+sed '/Host Timestamp/d' n3.txt > nots.txt
+"$TRACE_MERGE" n1.txt nots.txt > nots_merged.txt 2> nots.err || fail "merge with untimestamped input failed"
+[ "$(summary nots_merged.txt | wc -l)" = 3 ] || fail "untimestamped records should be skipped"
+grep -q 'nots.txt: skipped 3 records without a Host Timestamp' nots.err || fail "skipped records not reported"
+grep -q 'nots.txt: no mergeable records found' nots.err || fail "empty input not reported"
+
+if [ "$FAILED" -eq 0 ]; then
+  echo "PASS: trace_merge"
+fi
+exit "$FAILED"
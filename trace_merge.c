@@ -0,0 +1,710 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+
+/*
+ * Merge per-node gpu_metrics8_throttling traces into one globally ordered trace.
+ *
+ * Each input is a file as appended by run.sh, holding two kinds of record:
+ *   - "GPU Metrics for Card N:" blocks, keyed by their "Host Timestamp"
+ *     (collector --timestamp). The per-GPU System Clock Counter is not
+ *     comparable across cards or nodes, so blocks without a host timestamp
+ *     are skipped and counted.
+ *   - single EVENT/PRE lines from the throttle event engine, keyed by their
+ *     "ts=" field and tagged with their own "card=".
+ * A per-node clock offset is subtracted from every key.
+ *
+ * Event lines are written when an edge is confirmed, which is after the sample
+ * they are timestamped with (debounce, hold, pretrigger), so inputs are only
+ * nearly sorted. Each input therefore keeps a bounded reorder window of up to
+ * --window records in a min-heap, and the window heads are k-way merged
+ * through a second binary min-heap.
+ */
+
+#define LINE_BUF_SIZE 1024
+#define MAX_RECORD_BYTES (64 * 1024)
+#define IO_BUF_SIZE (64 * 1024)
+#define DEFAULT_WINDOW 256
+
+#define RECORD_HEADER "GPU Metrics for Card "
+#define HOST_TS_KEY "  Host Timestamp: "
+
+typedef struct {
+    char *node;
+    int64_t offset_ns;
+    bool used;
+} node_offset_t;
+
+typedef struct {
+    int64_t key_ns;
+    uint64_t seq;      /* read order within the input, keeps the merge stable */
+    int card_id;
+    bool is_line;      /* EVENT/PRE line rather than a metrics block */
+    size_t len;
+    char text[];       /* block body lines, or the whole EVENT/PRE line */
+} trace_record_t;
+
+typedef struct {
+    const char *path;
+    char node[256];
+    FILE *file;
+    char io_buf[IO_BUF_SIZE];
+    int64_t offset_ns;
+    bool eof;
+
+    /* Lookahead line: the start of the next record, if already read. */
+    char line[LINE_BUF_SIZE];
+    bool have_line;
+
+    /* Scratch space for the block being parsed. */
+    char body[MAX_RECORD_BYTES];
+
+    /* Reorder window: min-heap of parsed records not yet written. */
+    trace_record_t **pending;
+    size_t pending_count;
+    uint64_t next_seq;
+
+    int64_t last_key_ns;
+    bool warned_unsorted;
+    bool warned_truncated;
+    uint64_t records;
+    uint64_t skipped;
+    uint64_t malformed;
+} trace_input_t;
+
+static int parse_i64(const char *arg, int64_t *out)
+{
+    char *end = NULL;
+    long long value;
+
+    if (!arg || *arg == '\0')
+        return 0;
+
+    errno = 0;
+    value = strtoll(arg, &end, 10);
+    if (errno != 0 || !end || (*end != '\0' && *end != '\n' && *end != ' '))
+        return 0;
+
+    *out = (int64_t)value;
+    return 1;
+}
+
+static int parse_header(const char *line, int *card_id)
+{
+    char *end = NULL;
+    long value;
+
+    if (strncmp(line, RECORD_HEADER, strlen(RECORD_HEADER)) != 0)
+        return 0;
+
+    errno = 0;
+    value = strtol(line + strlen(RECORD_HEADER), &end, 10);
+    if (errno != 0 || !end || *end != ':' || value < 0 || value > INT32_MAX)
+        return 0;
+
+    *card_id = (int)value;
+    return 1;
+}
+
+static bool is_event_line(const char *line)
+{
+    return strncmp(line, "EVENT ", 6) == 0 || strncmp(line, "PRE ", 4) == 0;
+}
+
+static int parse_event_line(const char *line, int *card_id, int64_t *ts_ns)
+{
+    const char *card = strstr(line, " card=");
+    const char *ts = strstr(line, " ts=");
+    int64_t value;
+
+    if (!card || !ts || !parse_i64(card + 6, &value) || value < 0 || value > INT32_MAX)
+        return 0;
+    if (!parse_i64(ts + 4, ts_ns))
+        return 0;
+
+    *card_id = (int)value;
+    return 1;
+}
+
+/* Default node name: the trace's file name without directory or extension. */
+static void node_from_path(const char *path, char *node, size_t node_size)
+{
+    const char *slash = strrchr(path, '/');
+    const char *base = slash ? slash + 1 : path;
+    const char *dot = strrchr(base, '.');
+    size_t len = (dot && dot != base) ? (size_t)(dot - base) : strlen(base);
+
+    if (len >= node_size)
+        len = node_size - 1;
+    memcpy(node, base, len);
+    node[len] = '\0';
+}
+
+static trace_record_t *new_record(const char *text, size_t len)
+{
+    trace_record_t *rec = malloc(sizeof(*rec) + len);
+
+    if (!rec)
+        return NULL;
+    memcpy(rec->text, text, len);
+    rec->len = len;
+    return rec;
+}
+
+/*
+ * Parse the next record from an input.
+ * Returns 1 with *out set, 0 at end of input, -1 when out of memory.
+ */
+static int parse_record(trace_input_t *in, trace_record_t **out)
+{
+    for (;;) {
+        bool have_host_ts = false;
+        int64_t host_ts = 0;
+        size_t body_len = 0;
+        int card_id;
+
+        if (!in->have_line) {
+            if (!fgets(in->line, sizeof(in->line), in->file))
+                return 0;
+            in->have_line = true;
+        }
+
+        if (is_event_line(in->line)) {
+            int64_t ts_ns;
+
+            in->have_line = false;
+            if (!parse_event_line(in->line, &card_id, &ts_ns)) {
+                in->malformed++;
+                continue;
+            }
+            *out = new_record(in->line, strlen(in->line));
+            if (!*out)
+                return -1;
+            (*out)->is_line = true;
+            (*out)->card_id = card_id;
+            (*out)->key_ns = ts_ns;
+            return 1;
+        }
+
+        /* Skip anything else (legend, blank lines) until a block header. */
+        in->have_line = false;
+        if (!parse_header(in->line, &card_id))
+            continue;
+
+        while (fgets(in->line, sizeof(in->line), in->file)) {
+            int next_card;
+            size_t len;
+
+            if (parse_header(in->line, &next_card) || is_event_line(in->line)) {
+                in->have_line = true;
+                break;
+            }
+            if (in->line[0] == '\n')
+                continue;
+
+            if (strncmp(in->line, HOST_TS_KEY, strlen(HOST_TS_KEY)) == 0) {
+                have_host_ts = parse_i64(in->line + strlen(HOST_TS_KEY), &host_ts);
+                continue;
+            }
+
+            len = strlen(in->line);
+            if (body_len + len >= sizeof(in->body)) {
+                if (!in->warned_truncated) {
+                    fprintf(stderr, "Warning: %s: record exceeds %d bytes, truncating\n",
+                            in->path, MAX_RECORD_BYTES);
+                    in->warned_truncated = true;
+                }
+                continue;
+            }
+            memcpy(in->body + body_len, in->line, len);
+            body_len += len;
+        }
+
+        if (!have_host_ts) {
+            in->skipped++;
+            continue;
+        }
+
+        *out = new_record(in->body, body_len);
+        if (!*out)
+            return -1;
+        (*out)->is_line = false;
+        (*out)->card_id = card_id;
+        (*out)->key_ns = host_ts;
+        return 1;
+    }
+}
+
+static bool record_less(const trace_record_t *a, const trace_record_t *b)
+{
+    if (a->key_ns != b->key_ns)
+        return a->key_ns < b->key_ns;
+    return a->seq < b->seq;
+}
+
+static void pending_sift_up(trace_input_t *in, size_t pos)
+{
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!record_less(in->pending[pos], in->pending[parent]))
+            return;
+
+        trace_record_t *tmp = in->pending[pos];
+        in->pending[pos] = in->pending[parent];
+        in->pending[parent] = tmp;
+        pos = parent;
+    }
+}
+
+static void pending_sift_down(trace_input_t *in, size_t pos)
+{
+    for (;;) {
+        size_t left = 2 * pos + 1;
+        size_t right = left + 1;
+        size_t smallest = pos;
+
+        if (left < in->pending_count && record_less(in->pending[left], in->pending[smallest]))
+            smallest = left;
+        if (right < in->pending_count && record_less(in->pending[right], in->pending[smallest]))
+            smallest = right;
+        if (smallest == pos)
+            return;
+
+        trace_record_t *tmp = in->pending[pos];
+        in->pending[pos] = in->pending[smallest];
+        in->pending[smallest] = tmp;
+        pos = smallest;
+    }
+}
+
+/* Top up the reorder window. Returns 0 when out of memory. */
+static int fill_window(trace_input_t *in, size_t window)
+{
+    while (!in->eof && in->pending_count < window) {
+        trace_record_t *rec;
+        int rc = parse_record(in, &rec);
+
+        if (rc < 0)
+            return 0;
+        if (rc == 0) {
+            in->eof = true;
+            break;
+        }
+
+        rec->key_ns -= in->offset_ns;
+        rec->seq = in->next_seq++;
+        in->pending[in->pending_count++] = rec;
+        pending_sift_up(in, in->pending_count - 1);
+    }
+    return 1;
+}
+
+/* Remove the earliest record in the window; the caller frees it. */
+static trace_record_t *pop_record(trace_input_t *in)
+{
+    trace_record_t *rec = in->pending[0];
+
+    in->pending[0] = in->pending[--in->pending_count];
+    pending_sift_down(in, 0);
+
+    if (in->records > 0 && rec->key_ns < in->last_key_ns && !in->warned_unsorted) {
+        fprintf(stderr, "Warning: %s: records arrive later than the reorder window; "
+                "output will not be fully ordered (raise --window)\n", in->path);
+        in->warned_unsorted = true;
+    }
+    in->last_key_ns = rec->key_ns;
+    in->records++;
+    return rec;
+}
+
+static bool heap_less(trace_input_t *const *inputs, size_t a, size_t b)
+{
+    const trace_record_t *ra = inputs[a]->pending[0];
+    const trace_record_t *rb = inputs[b]->pending[0];
+
+    if (ra->key_ns != rb->key_ns)
+        return ra->key_ns < rb->key_ns;
+    /* Break ties by input order so the merge is stable. */
+    return a < b;
+}
+
+static void heap_sift_down(size_t *heap, size_t count, size_t pos, trace_input_t *const *inputs)
+{
+    for (;;) {
+        size_t left = 2 * pos + 1;
+        size_t right = left + 1;
+        size_t smallest = pos;
+
+        if (left < count && heap_less(inputs, heap[left], heap[smallest]))
+            smallest = left;
+        if (right < count && heap_less(inputs, heap[right], heap[smallest]))
+            smallest = right;
+        if (smallest == pos)
+            return;
+
+        size_t tmp = heap[pos];
+        heap[pos] = heap[smallest];
+        heap[smallest] = tmp;
+        pos = smallest;
+    }
+}
+
+static void write_record(FILE *out, const char *node, const trace_record_t *rec)
+{
+    if (rec->is_line) {
+        /* Tag in place: "EVENT start node=X merged_ts=T card=N ..." */
+        const char *card = strstr(rec->text, " card=");
+        size_t prefix = (size_t)(card - rec->text);
+
+        fwrite(rec->text, 1, prefix, out);
+        fprintf(out, " node=%s merged_ts=%" PRId64, node, rec->key_ns);
+        fwrite(rec->text + prefix, 1, rec->len - prefix, out);
+        return;
+    }
+
+    fprintf(out, "\n" RECORD_HEADER "%d:\n", rec->card_id);
+    fprintf(out, "  Node: %s\n", node);
+    fprintf(out, "  Merged Timestamp: %" PRId64 " ns\n", rec->key_ns);
+    fwrite(rec->text, 1, rec->len, out);
+}
+
+static int add_offset(node_offset_t **offsets, size_t *count, size_t *cap,
+                      const char *node, size_t node_len, int64_t offset_ns)
+{
+    for (size_t i = 0; i < *count; ++i) {
+        if (strlen((*offsets)[i].node) == node_len &&
+            strncmp((*offsets)[i].node, node, node_len) == 0) {
+            (*offsets)[i].offset_ns = offset_ns;
+            return 1;
+        }
+    }
+
+    if (*count == *cap) {
+        size_t new_cap = *cap ? *cap * 2 : 16;
+        node_offset_t *grown = realloc(*offsets, new_cap * sizeof(**offsets));
+        if (!grown)
+            return 0;
+        *offsets = grown;
+        *cap = new_cap;
+    }
+
+    char *copy = malloc(node_len + 1);
+    if (!copy)
+        return 0;
+    memcpy(copy, node, node_len);
+    copy[node_len] = '\0';
+
+    (*offsets)[*count].node = copy;
+    (*offsets)[*count].offset_ns = offset_ns;
+    (*offsets)[*count].used = false;
+    (*count)++;
+    return 1;
+}
+
+/*
+ * Offsets file: one "NODE OFFSET_NS" pair per line, '#' starts a comment.
+ * OFFSET_NS is how far the node's clock runs ahead of the reference clock.
+ */
+static int load_offsets(const char *path, node_offset_t **offsets, size_t *count, size_t *cap)
+{
+    char line[LINE_BUF_SIZE];
+    unsigned line_no = 0;
+    FILE *file = fopen(path, "r");
+
+    if (!file) {
+        fprintf(stderr, "Error opening %s: %s\n", path, strerror(errno));
+        return 0;
+    }
+
+    while (fgets(line, sizeof(line), file)) {
+        char node[LINE_BUF_SIZE];
+        char value[LINE_BUF_SIZE];
+        int64_t offset_ns;
+
+        line_no++;
+        char *hash = strchr(line, '#');
+        if (hash)
+            *hash = '\0';
+
+        int fields = sscanf(line, "%1023s %1023s", node, value);
+        if (fields <= 0)
+            continue;
+        if (fields != 2 || !parse_i64(value, &offset_ns)) {
+            fprintf(stderr, "Invalid offset at %s:%u\n", path, line_no);
+            fclose(file);
+            return 0;
+        }
+        if (!add_offset(offsets, count, cap, node, strlen(node), offset_ns)) {
+            fprintf(stderr, "Out of memory reading %s\n", path);
+            fclose(file);
+            return 0;
+        }
+    }
+
+    fclose(file);
+    return 1;
+}
+
+static void print_usage(const char *prog)
+{
+    printf("Usage: %s [-o OUT] [--offsets FILE] [--offset NODE=NS]... [--window N] [NODE=]TRACE...\n", prog);
+    printf("  NODE=TRACE            Per-node trace (node defaults to the file name sans extension)\n");
+    printf("  -o OUT, --output OUT  Write the merged trace to OUT (default stdout)\n");
+    printf("  --offsets FILE        Read \"NODE OFFSET_NS\" lines (e.g. step_function --clock_offsets)\n");
+    printf("  --offset NODE=NS      Clock offset of NODE relative to the reference clock\n");
+    printf("  --window N            Per-input reorder window in records (default %d)\n", DEFAULT_WINDOW);
+    printf("  Once any offset is given, every input node must have one.\n");
+    printf("  -h, --help            Show this help\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *output_path = NULL;
+    node_offset_t *offsets = NULL;
+    size_t offset_count = 0;
+    size_t offset_cap = 0;
+    trace_input_t **inputs;
+    size_t input_count = 0;
+    unsigned window = DEFAULT_WINDOW;
+    int status = EXIT_FAILURE;
+
+    inputs = calloc((size_t)argc, sizeof(*inputs));
+    if (!inputs) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            status = EXIT_SUCCESS;
+            goto cleanup;
+        }
+        if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Missing path after %s\n", argv[i]);
+                goto cleanup;
+            }
+            output_path = argv[++i];
+            continue;
+        }
+        if (strcmp(argv[i], "--window") == 0) {
+            int64_t value;
+
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Missing record count after %s\n", argv[i]);
+                goto cleanup;
+            }
+            ++i;
+            if (!parse_i64(argv[i], &value) || value < 1 || value > 1000000) {
+                fprintf(stderr, "Invalid window: %s\n", argv[i]);
+                goto cleanup;
+            }
+            window = (unsigned)value;
+            continue;
+        }
+        if (strcmp(argv[i], "--offsets") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Missing path after %s\n", argv[i]);
+                goto cleanup;
+            }
+            if (!load_offsets(argv[++i], &offsets, &offset_count, &offset_cap))
+                goto cleanup;
+            continue;
+        }
+        if (strcmp(argv[i], "--offset") == 0) {
+            const char *eq;
+            int64_t offset_ns;
+
+            if (i + 1 >= argc) {
+                fprintf(stderr, "Missing NODE=NS after %s\n", argv[i]);
+                goto cleanup;
+            }
+            ++i;
+            eq = strchr(argv[i], '=');
+            if (!eq || eq == argv[i] || !parse_i64(eq + 1, &offset_ns)) {
+                fprintf(stderr, "Invalid offset: %s\n", argv[i]);
+                goto cleanup;
+            }
+            if (!add_offset(&offsets, &offset_count, &offset_cap,
+                            argv[i], (size_t)(eq - argv[i]), offset_ns)) {
+                fprintf(stderr, "Out of memory\n");
+                goto cleanup;
+            }
+            continue;
+        }
+        if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            goto cleanup;
+        }
+
+        trace_input_t *in = calloc(1, sizeof(*in));
+        if (!in) {
+            fprintf(stderr, "Out of memory\n");
+            goto cleanup;
+        }
+        inputs[input_count++] = in;
+
+        char *eq = strchr(argv[i], '=');
+        if (eq && eq != argv[i]) {
+            *eq = '\0';
+            snprintf(in->node, sizeof(in->node), "%s", argv[i]);
+            in->path = eq + 1;
+        } else {
+            node_from_path(argv[i], in->node, sizeof(in->node));
+            in->path = argv[i];
+        }
+    }
+
+    if (input_count == 0) {
+        fprintf(stderr, "No input traces given\n");
+        print_usage(argv[0]);
+        goto cleanup;
+    }
+
+    /*
+     * Once any offsets are given, every input must have one: silently merging
+     * one node uncorrected (e.g. a file-name node vs. an MPI processor name)
+     * would misorder the whole trace.
+     */
+    bool missing_offset = false;
+    for (size_t i = 0; i < input_count; ++i) {
+        trace_input_t *in = inputs[i];
+        bool matched = false;
+
+        for (size_t j = 0; j < offset_count; ++j) {
+            if (strcmp(offsets[j].node, in->node) == 0) {
+                in->offset_ns = offsets[j].offset_ns;
+                offsets[j].used = true;
+                matched = true;
+                break;
+            }
+        }
+        if (offset_count > 0 && !matched) {
+            fprintf(stderr, "Error: no clock offset for node '%s' (%s); use NODE=TRACE to name it\n",
+                    in->node, in->path);
+            missing_offset = true;
+        }
+    }
+    for (size_t j = 0; j < offset_count; ++j) {
+        if (!offsets[j].used)
+            fprintf(stderr, "Warning: clock offset for node '%s' matches no input\n", offsets[j].node);
+    }
+    if (missing_offset)
+        goto cleanup;
+
+    for (size_t i = 0; i < input_count; ++i) {
+        trace_input_t *in = inputs[i];
+
+        in->file = fopen(in->path, "r");
+        if (!in->file) {
+            fprintf(stderr, "Error opening %s: %s\n", in->path, strerror(errno));
+            goto cleanup;
+        }
+        setvbuf(in->file, in->io_buf, _IOFBF, sizeof(in->io_buf));
+
+        /* Sized only now: --window may follow the traces on the command line. */
+        in->pending = calloc(window, sizeof(*in->pending));
+        if (!in->pending) {
+            fprintf(stderr, "Out of memory\n");
+            goto cleanup;
+        }
+    }
+
+    FILE *out = stdout;
+    if (output_path) {
+        out = fopen(output_path, "w");
+        if (!out) {
+            fprintf(stderr, "Error opening %s: %s\n", output_path, strerror(errno));
+            goto cleanup;
+        }
+    }
+
+    size_t *heap = calloc(input_count, sizeof(*heap));
+    size_t heap_count = 0;
+    if (!heap) {
+        fprintf(stderr, "Out of memory\n");
+        if (out != stdout)
+            fclose(out);
+        goto cleanup;
+    }
+
+    bool out_of_memory = false;
+    for (size_t i = 0; i < input_count; ++i) {
+        if (!fill_window(inputs[i], window))
+            out_of_memory = true;
+        else if (inputs[i]->pending_count > 0)
+            heap[heap_count++] = i;
+    }
+    for (size_t i = heap_count / 2; i-- > 0;)
+        heap_sift_down(heap, heap_count, i, inputs);
+
+    uint64_t merged = 0;
+    while (heap_count > 0 && !out_of_memory) {
+        trace_input_t *in = inputs[heap[0]];
+        trace_record_t *rec = pop_record(in);
+
+        write_record(out, in->node, rec);
+        free(rec);
+        merged++;
+        if (!fill_window(in, window))
+            out_of_memory = true;
+        if (in->pending_count == 0)
+            heap[0] = heap[--heap_count];
+        heap_sift_down(heap, heap_count, 0, inputs);
+    }
+    free(heap);
+
+    status = EXIT_SUCCESS;
+    if (out_of_memory) {
+        fprintf(stderr, "Out of memory buffering records\n");
+        status = EXIT_FAILURE;
+    }
+    if (ferror(out)) {
+        fprintf(stderr, "Error writing merged trace\n");
+        status = EXIT_FAILURE;
+    }
+    if (out != stdout && fclose(out) != 0) {
+        fprintf(stderr, "Error closing %s: %s\n", output_path, strerror(errno));
+        status = EXIT_FAILURE;
+    }
+
+    for (size_t i = 0; i < input_count; ++i) {
+        trace_input_t *in = inputs[i];
+        if (ferror(in->file)) {
+            fprintf(stderr, "Error reading %s\n", in->path);
+            status = EXIT_FAILURE;
+        }
+        if (in->skipped)
+            fprintf(stderr, "Warning: %s: skipped %" PRIu64
+                    " records without a Host Timestamp (collect with --timestamp)\n",
+                    in->path, in->skipped);
+        if (in->malformed)
+            fprintf(stderr, "Warning: %s: skipped %" PRIu64 " EVENT/PRE lines without card= and ts=\n",
+                    in->path, in->malformed);
+        if (in->records == 0)
+            fprintf(stderr, "Warning: %s: no mergeable records found\n", in->path);
+    }
+    fprintf(stderr, "Merged %" PRIu64 " records from %zu traces\n", merged, input_count);
+
+cleanup:
+    for (size_t i = 0; i < input_count; ++i) {
+        trace_input_t *in = inputs[i];
+        if (in->file)
+            fclose(in->file);
+        for (size_t j = 0; j < in->pending_count; ++j)
+            free(in->pending[j]);
+        free(in->pending);
+        free(in);
+    }
+    free(inputs);
+    for (size_t i = 0; i < offset_count; ++i)
+        free(offsets[i].node);
+    free(offsets);
+    return status;
+}